@@ -1,8 +1,36 @@
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <array>
+#include <utility>
+#include <cstdint>
 #include <sstream>
+#include <fstream>
 #include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <algorithm>
+#include <unordered_map>
 #include <ctime>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "reference_engine.h"
 using namespace std;
 enum Type {Concert, Games, Convention, Conference}; //enum declared so that types only takes 4 values, in rest it throws error
 
@@ -13,6 +41,120 @@ struct Reservation{
     string enddate;
 };
 
+//structure for recurring events, one rule stands for every occurrence inside the reservation
+struct RecurringEvent{
+    string cname;
+    string eventname;
+    string fromhour, tohour;
+    long firstday, lastday;//day numbers of the reservation bounding the rule
+    int step;//1 for daily and 7 for weekly rules
+    set<long> cancelled;//occurrences removed through deleteEvent
+    Type ctype;//type of the congregation, for the analytics
+
+    bool occursOn(long day) const{
+        return day >= firstday && day <= lastday && (day - firstday) % step == 0 && cancelled.count(day) == 0;
+    }
+};
+
+//structure for the counters of a country, kept up to date on every change so the analytics need no scan
+struct CountryStats{
+    long long bookedminutes = 0;
+    long long seatminutes = 0;//booked minutes weighted by the capacity of the venue
+    long long reserveddays = 0;
+};
+
+//fenwick tree counting events per day, so the events over a range of days are summed in logarithmic time.
+//The tree only covers the days that were counted and doubles when a day falls outside of it
+class DayCounter{
+    private:
+        static const long span = 1 << 19;//most days covered by the tree
+        long first = 0;//day of the first slot of the tree
+        vector<int> tree;
+        map<long, long> outside;//days that do not fit in the span
+
+        long slots() const{
+            return tree.empty() ? 0 : tree.size() - 1;
+        }
+
+        long prefix(long day) const{
+            long total = 0;
+            day = min(day - first, slots() - 1);
+            if(day < 0){
+                return 0;
+            }
+            for(long i = day + 1; i > 0; i -= i & -i){
+                total += tree[i];
+            }
+            return total;
+        }
+
+        //rebuilds the tree so it covers the day too, false if it would cover more than the span
+        bool grow(long day){
+            long low = tree.empty() ? day : min(first, day);
+            long high = tree.empty() ? day + 1 : max(first + slots(), day + 1);
+            long size = max(2 * slots(), 64L);
+            while(size < high - low){
+                size *= 2;
+            }
+            if(size > span){
+                return false;
+            }
+            //the counts of each day are taken back out of the old tree, in the reverse order of building it
+            for(long i = slots(); i > 0; i--){
+                if(i + (i & -i) <= slots()){
+                    tree[i + (i & -i)] -= tree[i];
+                }
+            }
+            long newfirst = day < first ? high - size : low;
+            vector<int> newtree(size + 1, 0);
+            for(long i = 1; i <= slots(); i++){
+                newtree[first - newfirst + i] = tree[i];
+            }
+            for(long i = 1; i <= size; i++){
+                if(i + (i & -i) <= size){
+                    newtree[i + (i & -i)] += newtree[i];
+                }
+            }
+            tree.swap(newtree);
+            first = newfirst;
+            return true;
+        }
+
+    public:
+        void add(long day, int value){
+            if((day < first || day >= first + slots()) && !grow(day)){
+                outside[day] += value;
+                return;
+            }
+            for(long i = day - first + 1; i <= slots(); i += i & -i){
+                tree[i] += value;
+            }
+        }
+
+        long count(long from, long to) const{
+            long total = prefix(to) - prefix(from - 1);
+            for(auto it = outside.lower_bound(from); it != outside.end() && it->first <= to; it++){
+                total += it->second;
+            }
+            return total;
+        }
+
+        size_t bytes() const{
+            return tree.capacity() * sizeof(int) + outside.size() * (sizeof(pair<long, long>) + 4 * sizeof(void*));
+        }
+};
+
+//structure for a materialized calendar (attribute for eventlist), holds the pre-rendered output of showCalendar
+struct CalendarView{
+    vector<string> dates;//every day of the reservation, in the order showCalendar prints them
+    unordered_map<string, size_t> dayindex;//position of each day in dates
+    vector<string> days;//pre-rendered block of each day
+    vector<int> counts;//number of events of each day
+    vector<bool> dirty;//days whose block has to be rendered again
+    string rendered;//whole output of showCalendar
+    bool stale = true;
+};
+
 //function to extract quoted part to iss in istringstream
 bool readQuotedString(istringstream &iss, string &result){
     result.clear();
@@ -61,7 +203,8 @@ string addMinutes(const string& datetime, int minutesToAdd) {
     timeEpoch += minutesToAdd * 60; // convert minutes to seconds
 
     //convert back to struct tm
-    tm* newTimeStruct = localtime(&timeEpoch);
+    tm newTime;
+    tm* newTimeStruct = localtime_r(&timeEpoch, &newTime);
 
     //convert the updated struct tm back into a string manually
     ostringstream oss;
@@ -74,6 +217,155 @@ string addMinutes(const string& datetime, int minutesToAdd) {
     return oss.str();
 }
 
+//function to convert a date into the number of days since 1970-01-01, so dates can be stepped without ctime
+long dayNumber(const string& date){
+    int year = 0, month = 0, day = 0;
+    sscanf(date.c_str(), "%d-%d-%d", &year, &month, &day);
+    year -= month <= 2;
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long yoe = year - era * 400;
+    long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+//function to convert a day number back into a YYYY-MM-DD string
+string dateFromDayNumber(long days){
+    days += 719468;
+    long era = (days >= 0 ? days : days - 146096) / 146097;
+    long doe = days - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    int day = doy - (153 * mp + 2) / 5 + 1;
+    int month = mp < 10 ? mp + 3 : mp - 9;
+    int year = yoe + era * 400 + (month <= 2);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+//function to get the day number of today's date
+long todayNumber(){
+    time_t t = time(nullptr);
+    tm today;
+    localtime_r(&t, &today);
+    return dayNumber(to_string(today.tm_year + 1900) + "-" + to_string(today.tm_mon + 1) + "-" + to_string(today.tm_mday));
+}
+
+//function to get the YYYY-MM month of a date, archived data is partitioned by month
+string monthOf(const string& date){
+    return dateFromDayNumber(dayNumber(date)).substr(0, 7);
+}
+
+//function to get the length of an event in minutes, an event ending at or before its start time ends on the next day
+int eventMinutes(const string& fromhour, const string& tohour){
+    int fromh = 0, fromm = 0, toh = 0, tom = 0;
+    sscanf(fromhour.c_str(), "%d:%d", &fromh, &fromm);
+    sscanf(tohour.c_str(), "%d:%d", &toh, &tom);
+    int from = fromh*60 + fromm, to = toh*60 + tom;
+    if(to <= from){
+        to += 24*60;
+    }
+    return to - from;
+}
+
+//function to print an amount in hundredths with two decimals
+string formatHundredths(long long value){
+    string sign = value < 0 ? "-" : "";
+    value = llabs(value);
+    string fraction = to_string(value % 100);
+    return sign + to_string(value / 100) + "." + (fraction.size() < 2 ? "0" : "") + fraction;
+}
+
+//function to build the key of a venue, as venue names are only unique together with the country
+string venueKey(const string& venuename, const string& country){
+    return venuename + '\n' + country;
+}
+
+//function to estimate the heap memory of a string, short strings are stored inside the object itself
+size_t stringBytes(const string& str){
+    const char *data = str.data();
+    if (data >= reinterpret_cast<const char*>(&str) && data < reinterpret_cast<const char*>(&str + 1)){
+        return 0;
+    }
+    return str.capacity() + 1;
+}
+
+//approximate bookkeeping memory of one node of a set or map, and of an unordered_map
+const size_t treeNodeBytes = 4 * sizeof(void*);
+const size_t hashNodeBytes = 2 * sizeof(void*);
+
+//separator of the fields of an archived record
+const char recordSeparator = '\x1f';
+
+//function to append a number in groups of 7 bits, numbers below 128 take a single byte
+void putVarint(string &out, size_t value){
+    while (value >= 0x80){
+        out += char((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += char(value);
+}
+
+//function to read a number written by putVarint, false if the data ends first
+bool getVarint(const string& in, size_t &pos, size_t &value){
+    value = 0;
+    for (int shift = 0; pos < in.size() && shift < 64; shift += 7){
+        unsigned char byte = in[pos++];
+        value |= size_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)){
+            return true;
+        }
+    }
+    return false;
+}
+
+//function to encode records as a block of a segment file, the records are sorted and front coded: each one is stored as
+//the length of the prefix it shares with the previous one and the rest of it, so records of the same day and venue cost
+//little more than their names. A block is its record count, its size in bytes and the coded records
+string segmentBlock(vector<string> records){
+    sort(records.begin(), records.end());
+    string payload, previous;
+    for (auto &record : records){
+        size_t shared = 0;
+        while (shared < previous.size() && shared < record.size() && previous[shared] == record[shared]){
+            shared++;
+        }
+        putVarint(payload, shared);
+        putVarint(payload, record.size() - shared);
+        payload.append(record, shared, string::npos);
+        previous = record;
+    }
+    string block;
+    putVarint(block, records.size());
+    putVarint(block, payload.size());
+    return block + payload;
+}
+
+//function to read every record of a segment file, a block cut short by a crash is skipped
+vector<string> readSegment(const string& path){
+    vector<string> records;
+    error_code ec;
+    ifstream file(path, ios::binary);
+    if (!filesystem::is_regular_file(path, ec) || !file){
+        return records;
+    }
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    size_t pos = 0, count = 0, size = 0;
+    while (getVarint(data, pos, count) && getVarint(data, pos, size) && size <= data.size() - pos){
+        size_t end = pos + size, shared = 0, length = 0;
+        string previous;
+        for (size_t i = 0; i < count && getVarint(data, pos, shared) && getVarint(data, pos, length) && pos <= end && shared <= previous.size() && length <= end - pos; i++){
+            previous = previous.substr(0, shared) + data.substr(pos, length);
+            pos += length;
+            records.push_back(previous);
+        }
+        pos = end;
+    }
+    return records;
+}
+
 //function to check if the year is a leap year
 bool isLeapYear(int year) {
     return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
@@ -93,7 +385,8 @@ bool isValidDate(int year, int month, int day) {
 bool isGreaterDate(int year, int month, int day) {
     //get current date
     time_t t = time(nullptr);
-    tm* now = localtime(&t);
+    tm today;
+    tm* now = localtime_r(&t, &today);
 
     int currentYear = now->tm_year + 1900;
     int currentMonth = now->tm_mon + 1;
@@ -107,15 +400,23 @@ bool isGreaterDate(int year, int month, int day) {
     return false;
 }
 
-//function to validate and compare the input date with today's date
-bool isValidAndFutureDate(const string& dateStr) {
-    int year, month, day;
+//function to parse and validate a date string
+bool parseDate(const string& dateStr, int &year, int &month, int &day) {
     char dash1, dash2;
 
     istringstream iss(dateStr);
     if (!(iss >> year >> dash1 >> month >> dash2 >> day) || dash1 != '-' || dash2 != '-' || !isValidDate(year, month, day)) {
         return false;
     }
+    return true;
+}
+
+//function to validate and compare the input date with today's date
+bool isValidAndFutureDate(const string& dateStr) {
+    int year, month, day;
+    if (!parseDate(dateStr, year, month, day)) {
+        return false;
+    }
 
     return isGreaterDate(year, month, day);
 }
@@ -167,15 +468,23 @@ bool isValidTime(const string& time) {
     return true;
 }
 
-//convert the declared enum to string for printing
-string typeToString(Type type) {
-    switch(type) {
-        case Concert: return "Concert";
-        case Games: return "Games";
-        case Convention: return "Convention";
-        case Conference: return "Conference";
-        default: return "Unknown";
+//names of the declared enum, indexed by its value
+constexpr string_view typeNames[] = {"Concert", "Games", "Convention", "Conference"};
+
+//convert a string to the declared enum, returns false for the strings that are not a type
+constexpr bool stringToType(string_view inputtype, Type &type){
+    for (size_t i = 0; i < size(typeNames); i++){
+        if (typeNames[i] == inputtype){
+            type = static_cast<Type>(i);
+            return true;
+        }
     }
+    return false;
+}
+
+//convert the declared enum to string for printing
+constexpr string_view typeToString(Type type) {
+    return type >= Concert && type <= Conference ? typeNames[type] : "Unknown";
 }
 
 class Congregation{
@@ -186,15 +495,9 @@ class Congregation{
         string cenddate;
 
     public:
-        Congregation(string inputname = "", string inputtype = "", string inputstartdate = "2024-12-31", string inputenddate = "2024-01-01"){
-            if (inputtype == "Concert") ctype = Concert;
-            else if (inputtype == "Games") ctype = Games;
-            else if (inputtype == "Convention") ctype = Convention;
-            else if (inputtype == "Conference") ctype = Conference;
-            else{
-                cout << "-1" << endl << "Error" << endl;
-                return;
-            }
+        //the type is validated while parsing the command
+        Congregation(string inputname = "", Type inputtype = Concert, string inputstartdate = "2024-12-31", string inputenddate = "2024-01-01"){
+            ctype = inputtype;
             cname = inputname;
             cstartdate = inputstartdate;
             cenddate = inputenddate;
@@ -215,7 +518,7 @@ class CongregationList{
         }
 
         //fuction to add congregation
-        void addCongregation(string inputname, string inputtype, string inputstartdate, string inputenddate){
+        void addCongregation(string inputname, Type inputtype, string inputstartdate, string inputenddate){
             //problem assumed that all congregations names are unique
             for (auto element : congregationlist){
                 if(element.cname == inputname){
@@ -258,7 +561,7 @@ class CongregationList{
         }
     
     friend class VenueList;
-    friend class Eventlist;
+    friend class EventList;
 }; 
 
 class Venue{
@@ -345,7 +648,7 @@ class VenueList{
             return;
         }
     
-        void reserveVenue(string venuename, string country, string cname){
+        bool reserveVenue(string venuename, string country, string cname){
             //search for the congregation
             for(auto celement : congregations.congregationlist){
                 if (celement.cname == cname){
@@ -356,21 +659,21 @@ class VenueList{
                                 //check if available for reservation or not
                                 if((celement.cstartdate>=element.startdate && celement.cstartdate<=element.enddate) || (celement.cenddate>=element.startdate && celement.cenddate<=element.enddate)){
                                     cout << -1 << endl << "Error" << endl;
-                                    return;
+                                    return false;
                                 }
                             }
                             velement.reservations.push_back({celement.cname,celement.cstartdate,celement.cenddate});
                             cout << "0" << endl;
-                            return;
+                            return true;
                         }
                     }
                 }
             }
             cout << "-1" << endl << "Error" << endl;
-            return;
+            return false;
         }
 
-        void freeVenue(string venuename, string country, string cname){
+        bool freeVenue(string venuename, string country, string cname){
             //search for the venue
             for(auto &velement : venuelist){
                 if(velement.name == venuename && velement.country == country){
@@ -379,13 +682,13 @@ class VenueList{
                         if(velement.reservations[i].cname == cname){
                             velement.reservations.erase(velement.reservations.begin()+i);
                             cout << 0 << endl;
-                            return;
+                            return true;
                         }
                     }
                 }
             }
             cout << -1 << endl << "Error" << endl;
-            return;
+            return false;
         }
 
         void showReserved(string cname){
@@ -433,6 +736,22 @@ class VenueList{
     friend class EventList;
 };
 
+//function to check if an event to be added leaves less than 30 minutes of gap to an existing event of the venue
+bool eventsClash(const string& inputdate, const string& inputfromhour, const string& inputtohour, const string& date, const string& fromhour, const string& tohour){
+    string toaddstart = inputdate+string("-")+inputfromhour;
+    string toaddend = inputdate+string("-")+inputtohour;
+    string eventstart = date+string("-")+fromhour;
+    string eventend = date+string("-")+tohour;
+    //check if events have enough gap
+    if (eventend.substr(11,5) == "00:00"){
+        eventend = addMinutes(eventend, 24*60);
+    }
+    if (toaddend.substr(11,5) == "00:00"){
+        toaddend = addMinutes(toaddend, 24*60);
+    }
+    return !((addMinutes(toaddend,30)<=eventstart) || (toaddstart>=addMinutes(eventend,30)));
+}
+
 class Event{
     private:
     string eventname;
@@ -441,6 +760,8 @@ class Event{
     string country;
     string date;
     string fromhour, tohour;
+    Type ctype = Concert;//type of the congregation, for the analytics
+    long id = 0;//order in which the events were added, events wrapping past midnight can start together at a venue
     
     public:
         Event(string cname = "", string venuename = "", string country = "", string eventname = "", string date = "2024-12-31", string fromhour = 0, string tohour = 0){
@@ -453,17 +774,376 @@ class Event{
             this->tohour = tohour;
         }
 
+        //events are ordered by day, then start time, then venue and then the order they were added in
+        bool operator<(const Event& other) const{
+            return tie(date, fromhour, country, venuename, id) < tie(other.date, other.fromhour, other.country, other.venuename, other.id);
+        }
+
     friend class EventList; 
 };
 
+//orders pointers to events the same way as the events themselves
+struct EventPointerOrder{
+    bool operator()(const Event* a, const Event* b) const{
+        return *a < *b;
+    }
+};
+
 class EventList{
     private:
-        vector<Event> eventlist;
+        set<Event> eventlist;//all events in chronological order
+        unordered_map<string, set<const Event*, EventPointerOrder>> venueevents;//events of each venue in chronological order, keyed by venue
         VenueList venues;//this object is creted here for easy iteration
+        map<string, map<string, CalendarView>> calendars;//calendars of congregations, keyed by venue and then by congregation
+        map<string, vector<RecurringEvent>> recurring;//recurring event rules, keyed by venue
+        unordered_map<string, int> capacities;//capacity of the venues that had events, keyed by venue
+        unordered_map<string, unordered_map<long, int>> bookedminutes;//minutes booked on each day, keyed by venue
+        unordered_map<string, CountryStats> countrystats;//counters of each country
+        DayCounter typecounts[4];//events on each day, for each congregation type
+        long archivedthrough = 0;//days before this one have been moved to the archive
+        time_t nextarchivecheck = 0;//time of the next check for a new day
+        long lastid = 0;//id of the last added event
+
+        //removes an event from the eventlist and from the schedule of its venue, archived events stay in the analytics counters
+        set<Event>::iterator eraseEvent(set<Event>::iterator it, bool archived = false){
+            string venuekey = venueKey(it->venuename, it->country);
+            auto vit = venueevents.find(venuekey);
+            vit->second.erase(&*it);
+            if(vit->second.empty()){
+                venueevents.erase(vit);
+            }
+            invalidateCalendarDay(it->venuename, it->country, it->date);
+            if(!archived){
+                countEvent(venuekey, it->country, dayNumber(it->date), eventMinutes(it->fromhour, it->tohour), it->ctype, -1);
+            }
+            return eventlist.erase(it);
+        }
+
+        //returns the events of a venue in chronological order, empty if it has none
+        const set<const Event*, EventPointerOrder>& eventsAtVenue(const string& venuename, const string& country){
+            static const set<const Event*, EventPointerOrder> none;
+            auto vit = venueevents.find(venueKey(venuename, country));
+            return vit == venueevents.end() ? none : vit->second;
+        }
+
+        //finds the reservation of a congregation at a venue, returns the venue or nullptr if there is none
+        const Venue* findReservation(const string& cname, const string& venuename, const string& country, string &startdate, string &enddate){
+            for(auto &velement: venues.venuelist){
+                if(velement.name == venuename && velement.country == country){
+                    for(auto &relement : velement.reservations){
+                        if(relement.cname == cname){
+                            startdate = relement.startdate;
+                            enddate = relement.enddate;
+                            return &velement;
+                        }
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        //finds the type of a congregation
+        Type congregationType(const string& cname){
+            for(auto &celement : venues.congregations.congregationlist){
+                if(celement.cname == cname){
+                    return celement.ctype;
+                }
+            }
+            return Concert;
+        }
+
+        //keeps the analytics counters up to date, sign is 1 when an event is added and -1 when it is removed
+        void countEvent(const string& venuekey, const string& country, long day, int minutes, Type ctype, int sign){
+            auto &days = bookedminutes[venuekey];
+            days[day] += sign * minutes;
+            if(days[day] == 0){
+                days.erase(day);
+                if(days.empty()){
+                    bookedminutes.erase(venuekey);
+                }
+            }
+            CountryStats &stats = countrystats[country];
+            stats.bookedminutes += sign * minutes;
+            stats.seatminutes += (long long)sign * minutes * capacities[venuekey];
+            typecounts[ctype].add(day, sign);
+        }
+
+        //counts every occurrence of a recurring event
+        void countRule(const string& venuekey, const string& country, const RecurringEvent& rule, int sign){
+            int minutes = eventMinutes(rule.fromhour, rule.tohour);
+            for(long day = rule.firstday; day <= rule.lastday; day += rule.step){
+                if(rule.occursOn(day)){
+                    countEvent(venuekey, country, day, minutes, rule.ctype, sign);
+                }
+            }
+        }
+
+        //adds or removes the days of a reservation to the reserved days of its country
+        void countReservation(const string& country, const string& startdate, const string& enddate, int sign){
+            countrystats[country].reserveddays += sign * (dayNumber(enddate) - dayNumber(startdate) + 1);
+        }
+
+        //adds the occurrences of the recurring events of a venue on a day to the lines of that day, keeping them in time order
+        void addOccurrences(const string& venuename, const string& country, long day, vector<pair<string, string>> &lines){
+            auto rit = recurring.find(venueKey(venuename, country));
+            if(rit == recurring.end()){
+                return;
+            }
+            for(auto &rule : rit->second){
+                if(rule.occursOn(day)){
+                    size_t pos = 0;
+                    while(pos < lines.size() && lines[pos].first <= rule.fromhour){
+                        pos++;
+                    }
+                    lines.insert(lines.begin()+pos, {rule.fromhour, rule.eventname + " " + rule.fromhour + " " + rule.tohour + "\n"});
+                }
+            }
+        }
+
+        //marks every day of every calendar of that venue as changed
+        void invalidateCalendarVenue(const string& venuename, const string& country){
+            auto vit = calendars.find(venueKey(venuename, country));
+            if(vit == calendars.end()){
+                return;
+            }
+            for(auto &view : vit->second){
+                view.second.dirty.assign(view.second.dates.size(), true);
+                view.second.stale = true;
+            }
+        }
+
+        //removes the recurring events of a congregation, at one venue or at all of them if venuekey is empty, the occurrences
+        //of archived rules stay in the analytics counters
+        void dropRecurring(const string& cname, const string& venuekey, bool archived = false){
+            for(auto rit = recurring.begin(); rit != recurring.end();){
+                if(!venuekey.empty() && rit->first != venuekey){
+                    rit++;
+                    continue;
+                }
+                auto &rules = rit->second;
+                size_t before = rules.size();
+                size_t split = rit->first.find('\n');
+                for(size_t i=0;i<rules.size();){
+                    if(rules[i].cname == cname){
+                        if(!archived){
+                            countRule(rit->first, rit->first.substr(split + 1), rules[i], -1);
+                        }
+                        rules.erase(rules.begin() + i);
+                    }
+                    else{
+                        i++;
+                    }
+                }
+                if(rules.size() != before){
+                    invalidateCalendarVenue(rit->first.substr(0, split), rit->first.substr(split + 1));
+                }
+                if(rules.empty()){
+                    rit = recurring.erase(rit);
+                }
+                else{
+                    rit++;
+                }
+            }
+        }
+
+        //marks the day of an event as changed in every calendar of that venue
+        void invalidateCalendarDay(const string& venuename, const string& country, const string& date){
+            auto vit = calendars.find(venueKey(venuename, country));
+            if(vit == calendars.end()){
+                return;
+            }
+            for(auto &view : vit->second){
+                auto dit = view.second.dayindex.find(date);
+                if(dit != view.second.dayindex.end()){
+                    view.second.dirty[dit->second] = true;
+                    view.second.stale = true;
+                }
+            }
+        }
+
+        //drops the calendar of a congregation at a venue once its reservation is gone
+        void dropCalendar(const string& cname, const string& venuename, const string& country){
+            auto vit = calendars.find(venueKey(venuename, country));
+            if(vit == calendars.end()){
+                return;
+            }
+            vit->second.erase(cname);
+            if(vit->second.empty()){
+                calendars.erase(vit);
+            }
+        }
+
+        //creates the calendar for a reservation, every day starts out dirty
+        CalendarView makeCalendar(const string& startdate, const string& enddate){
+            CalendarView view;
+            for(string i = startdate; i<=enddate ; i = addMinutes(i+"-00:00",24*60).substr(0,10)){
+                view.dayindex[i] = view.dates.size();
+                view.dates.push_back(i);
+            }
+            view.days.resize(view.dates.size());
+            view.counts.resize(view.dates.size(), 0);
+            view.dirty.resize(view.dates.size(), true);
+            return view;
+        }
+
+        //renders the dirty days of a calendar again, looking up only the events of those days
+        void refreshCalendar(CalendarView &view, const string& venuename, const string& country){
+            if(!view.stale){
+                return;
+            }
+            vector<vector<pair<string, string>>> toprint(view.dates.size());
+            auto render = [&](const Event *element){
+                auto dit = view.dayindex.find(element->date);
+                if(dit != view.dayindex.end() && view.dirty[dit->second]){
+                    toprint[dit->second].push_back({element->fromhour, element->eventname + " " + element->fromhour + " " + element->tohour + "\n"});
+                }
+            };
+            //only the dirty days are looked up in the schedule of the venue, the events of a day are next to each other
+            const auto &schedule = eventsAtVenue(venuename, country);
+            for(size_t i=0;i<view.dates.size();i++){
+                if(!view.dirty[i]){
+                    continue;
+                }
+                Event from("", venuename, country, "", view.dates[i], "", "");
+                for(auto it = schedule.lower_bound(&from); it != schedule.end() && (*it)->date == view.dates[i]; it++){
+                    render(*it);
+                }
+            }
+            int totalcount = 0;
+            string wholetoprint = "\n";
+            for(size_t i=0;i<view.dates.size();i++){
+                if(view.dirty[i]){
+                    addOccurrences(venuename, country, dayNumber(view.dates[i]), toprint[i]);
+                    view.days[i] = view.dates[i] + " " + to_string(toprint[i].size()) + "\n";
+                    for(auto &line : toprint[i]){
+                        view.days[i] += line.second;
+                    }
+                    view.counts[i] = toprint[i].size();
+                    view.dirty[i] = false;
+                }
+                totalcount += view.counts[i];
+                wholetoprint += view.days[i];
+            }
+            view.rendered = to_string(totalcount) + wholetoprint;
+            view.stale = false;
+        }
+
+        //moves the events and the occurrences of recurring events before today, and the reservations that ended before today,
+        //into the segments of their month. The segments are written first, so nothing is dropped if the disk fails
+        bool sweepArchive(long today){
+            map<string, vector<string>> segments;//records to append, keyed by segment file
+            auto archiveEvent = [&](const string& date, const string& venuename, const string& country, const string& cname, const string& eventname, const string& fromhour, const string& tohour, Type ctype){
+                string record = date;
+                for(auto field : {&country, &venuename, &fromhour, &tohour, &cname, &eventname}){
+                    record += recordSeparator + *field;
+                }
+                segments["events-" + monthOf(date)].push_back(record + recordSeparator + to_string(ctype));
+            };
+            //the events are in date order, so the past ones are the ones before the first event of today
+            vector<Event> pastevents;
+            auto pastend = eventlist.lower_bound(Event("", "", "", "", dateFromDayNumber(today), "", ""));
+            for(auto it = eventlist.begin(); it != pastend; it++){
+                if(dayNumber(it->date) < today){
+                    archiveEvent(it->date, it->venuename, it->country, it->cname, it->eventname, it->fromhour, it->tohour, it->ctype);
+                    pastevents.push_back(*it);
+                }
+            }
+            vector<pair<Venue*, string>> pastreservations;
+            vector<Venue*> pastrules;//venues with recurring events that occurred before today
+            for(auto &velement : venues.venuelist){
+                //the past occurrences of every recurring event, the rules of reservations still running are kept for the days to come
+                auto rit = recurring.find(venueKey(velement.name, velement.country));
+                if(rit != recurring.end()){
+                    for(auto &rule : rit->second){
+                        for(long day = rule.firstday; day < today && day <= rule.lastday; day += rule.step){
+                            if(rule.occursOn(day)){
+                                archiveEvent(dateFromDayNumber(day), velement.name, velement.country, rule.cname, rule.eventname, rule.fromhour, rule.tohour, rule.ctype);
+                            }
+                        }
+                    }
+                    pastrules.push_back(&velement);
+                }
+                for(auto &relement : velement.reservations){
+                    if(dayNumber(relement.enddate) >= today){
+                        continue;
+                    }
+                    string record = velement.name + recordSeparator + velement.country + recordSeparator + relement.cname + recordSeparator + relement.startdate + recordSeparator + relement.enddate;
+                    segments["reservations-" + monthOf(relement.enddate)].push_back(record);
+                    pastreservations.push_back({&velement, relement.cname});
+                }
+            }
+            //every block is encoded before a file is touched, if any file cannot be written the ones already written
+            //are cut back to their old size, so a failed sweep leaves no copies behind when it is tried again
+            vector<pair<string, string>> blocks;//segment file and block to append to it
+            for(auto &segment : segments){
+                blocks.push_back({archivedir + "/" + segment.first + ".seg", segmentBlock(segment.second)});
+            }
+            error_code ec;
+            filesystem::create_directories(archivedir, ec);
+            vector<pair<string, uintmax_t>> written;//files appended to and their size before, -1 for new files
+            bool failed = false;
+            for(auto &block : blocks){
+                bool existed = filesystem::exists(block.first, ec);
+                if(existed && !filesystem::is_regular_file(block.first, ec)){
+                    failed = true;
+                    break;
+                }
+                written.push_back({block.first, existed ? filesystem::file_size(block.first, ec) : uintmax_t(-1)});
+                ofstream file(block.first, ios::binary | ios::app);
+                file.write(block.second.data(), block.second.size());
+                if(!file.flush()){
+                    failed = true;
+                    break;
+                }
+            }
+            if(failed){
+                for(auto &file : written){
+                    if(file.second == uintmax_t(-1)){
+                        filesystem::remove(file.first, ec);
+                    }
+                    else{
+                        filesystem::resize_file(file.first, file.second, ec);
+                    }
+                }
+                return false;
+            }
+            //the analytics keep counting what is archived, so they answer the same for past days
+            for(auto &element : pastevents){
+                eraseEvent(eventlist.find(element), true);
+            }
+            for(auto &past : pastreservations){
+                Venue &velement = *past.first;
+                dropRecurring(past.second, venueKey(velement.name, velement.country), true);
+                dropCalendar(past.second, velement.name, velement.country);
+                for(size_t i=0;i<velement.reservations.size();i++){
+                    if(velement.reservations[i].cname == past.second){
+                        velement.reservations.erase(velement.reservations.begin()+i);
+                        break;
+                    }
+                }
+            }
+            //the rules left start again on their first occurrence from today, which keeps weekly rules on their weekday
+            for(auto venue : pastrules){
+                auto rit = recurring.find(venueKey(venue->name, venue->country));
+                if(rit == recurring.end()){
+                    continue;
+                }
+                for(auto &rule : rit->second){
+                    if(rule.firstday < today){
+                        rule.firstday += (today - rule.firstday + rule.step - 1) / rule.step * rule.step;
+                        rule.cancelled.erase(rule.cancelled.begin(), rule.cancelled.lower_bound(rule.firstday));
+                    }
+                }
+                invalidateCalendarVenue(venue->name, venue->country);
+            }
+            archivedthrough = today;
+            return true;
+        }
     
     public:
+        string archivedir;//directory of the archived segments, archiving is off while it is empty
+
         EventList(){
-            eventlist = {};
         }
 
         //function to add event
@@ -474,6 +1154,7 @@ class EventList{
                 if(velement.name == inputvenuename && velement.country == country){
                     for(auto relement : velement.reservations){
                         if(relement.cname == cname && relement.startdate<=inputdate && relement.enddate>=inputdate){
+                            capacities[venueKey(inputvenuename, country)] = velement.capacity;
                             reserved = true;
                             break;
                         }
@@ -487,57 +1168,73 @@ class EventList{
                 cout << -1 << endl << "Error" << endl;
                 return;
             }
-            if(eventlist.empty()){
-                eventlist.push_back(Event(cname, inputvenuename, country, inputeventname, inputdate, inputfromhour, inputtohour));
-                cout << 0 << endl;
-                return;
-            }
-            //iterate till the date just before the event date
-            size_t pos = 0;
-            for(size_t i=0;i<eventlist.size();i++){
-                if((eventlist[i].date+'-'+eventlist[i].tohour)  <= (inputdate+'-'+inputfromhour)){
-                    pos++;
-                }
-                if(eventlist[i].country == country && eventlist[i].venuename == inputvenuename){
-                    string toaddstart = inputdate+string("-")+inputfromhour;
-                    string toaddend = inputdate+string("-")+inputtohour;
-                    string eventstart = eventlist[i].date+string("-")+eventlist[i].fromhour;
-                    string eventend = eventlist[i].date+string("-")+eventlist[i].tohour;
-                    //check if events have enough gap
-                    if (eventend.substr(11,5) == "00:00"){
-                        eventend = addMinutes(eventend, 24*60);
-                    }
-                    if (toaddend.substr(11,5) == "00:00"){
-                        toaddend = addMinutes(eventend, 24*60);
-                    }
-                    if((addMinutes(toaddend,30)<=eventstart) || (toaddstart>=addMinutes(eventend,30))){
-                        continue;
-                    }
-                    else{
-                        cout << -1 << endl << "Error" << endl;
-                        return;
+            //the occurrences of recurring events from the day before to the day after are part of the schedule of the venue as well
+            auto rit = recurring.find(venueKey(inputvenuename, country));
+            if(rit != recurring.end()){
+                long day = dayNumber(inputdate);
+                for(auto &rule : rit->second){
+                    for(long other = day - 1; other <= day + 1; other++){
+                        if(rule.occursOn(other) && eventsClash(inputdate, inputfromhour, inputtohour, dateFromDayNumber(other), rule.fromhour, rule.tohour)){
+                            cout << -1 << endl << "Error" << endl;
+                            return;
+                        }
                     }
                 }
             }
-            if(pos >= eventlist.size() - 1){
-                eventlist.push_back(Event(cname, inputvenuename, country, inputeventname, inputdate, inputfromhour, inputtohour));
-            }
-            else{
-                eventlist.insert(eventlist.begin()+pos, Event(cname, inputvenuename, country, inputdate, inputfromhour, inputtohour, inputeventname));
+            //only events of the venue from the day before to the day after can be too close to the new one
+            const auto &schedule = eventsAtVenue(inputvenuename, country);
+            auto first = schedule.begin();
+            auto last = schedule.end();
+            if(inputdate.size() == 10){
+                long day = dayNumber(inputdate);
+                Event from(cname, inputvenuename, country, "", dateFromDayNumber(day - 1), "", "");
+                Event to(cname, inputvenuename, country, "", dateFromDayNumber(day + 2), "", "");
+                first = schedule.lower_bound(&from);
+                last = schedule.lower_bound(&to);
+            }
+            for(auto it = first; it != last; it++){
+                if(eventsClash(inputdate, inputfromhour, inputtohour, (*it)->date, (*it)->fromhour, (*it)->tohour)){
+                    cout << -1 << endl << "Error" << endl;
+                    return;
+                }
             }
+            //the position in the eventlist is found in logarithmic time
+            Event newEvent(cname, inputvenuename, country, inputeventname, inputdate, inputfromhour, inputtohour);
+            newEvent.ctype = congregationType(cname);
+            newEvent.id = ++lastid;
+            auto inserted = eventlist.insert(newEvent).first;
+            venueevents[venueKey(inputvenuename, country)].insert(&*inserted);
+            countEvent(venueKey(inputvenuename, country), country, dayNumber(inputdate), eventMinutes(inputfromhour, inputtohour), newEvent.ctype, 1);
+            invalidateCalendarDay(inputvenuename, country, inputdate);
             cout << 0 << endl;
             return;
         }
 
         //function to delete event
         void deleteEvent(string cname, string inputvenuename, string country, string inputdate, string inputfromhour, string inputeventname){
-            //find the event to be deleted
-            for(size_t i=0;i<eventlist.size();i++){
-                if(eventlist[i].country == country && eventlist[i].venuename == inputvenuename && eventlist[i].cname == cname && eventlist[i].date == inputdate && eventlist[i].eventname == inputeventname && eventlist[i].fromhour == inputfromhour){
-                    eventlist.erase(eventlist.begin()+i);
-                    cout << 0 << endl;
-                    return;
-                } 
+            //find the event to be deleted among the events starting at that time at the venue
+            auto it = eventlist.lower_bound(Event(cname, inputvenuename, country, inputeventname, inputdate, inputfromhour, ""));
+            while(it != eventlist.end() && it->date == inputdate && it->fromhour == inputfromhour && it->country == country && it->venuename == inputvenuename && (it->cname != cname || it->eventname != inputeventname)){
+                it++;
+            }
+            if(it != eventlist.end() && it->date == inputdate && it->fromhour == inputfromhour && it->country == country && it->venuename == inputvenuename){
+                eraseEvent(it);
+                cout << 0 << endl;
+                return;
+            }
+            //otherwise it may be an occurrence of a recurring event, which is cancelled for that day only
+            auto rit = recurring.find(venueKey(inputvenuename, country));
+            if(rit != recurring.end()){
+                long day = dayNumber(inputdate);
+                for(auto &rule : rit->second){
+                    if(rule.cname == cname && rule.eventname == inputeventname && rule.fromhour == inputfromhour && rule.occursOn(day)){
+                        countEvent(rit->first, country, day, eventMinutes(rule.fromhour, rule.tohour), rule.ctype, -1);
+                        rule.cancelled.insert(day);
+                        invalidateCalendarDay(inputvenuename, country, inputdate);
+                        cout << 0 << endl;
+                        return;
+                    }
+                }
             }
             //if event not present
             cout << -1 << endl << "Error:in fuction" << endl;
@@ -560,11 +1257,17 @@ class EventList{
                 return;
             }
             //all the events to be printed are added to a string so as to print in one iteration
-            for(auto element : eventlist){
-                if(element.venuename == inputvenuename && element.country == country && element.date == inputdate){
-                    toprint += element.eventname + " " + element.fromhour + " " + element.tohour + "\n";
-                    count++;
-                }
+            vector<pair<string, string>> lines;
+            const auto &schedule = eventsAtVenue(inputvenuename, country);
+            Event from("", inputvenuename, country, "", inputdate, "", "");
+            for(auto it = schedule.lower_bound(&from); it != schedule.end() && (*it)->date == inputdate; it++){
+                lines.push_back({(*it)->fromhour, (*it)->eventname + " " + (*it)->fromhour + " " + (*it)->tohour + "\n"});
+            }
+            //occurrences of recurring events are expanded only for the day asked for
+            addOccurrences(inputvenuename, country, dayNumber(inputdate), lines);
+            for(auto &line : lines){
+                toprint += line.second;
+                count++;
             }
             cout << count << toprint; 
             return;
@@ -572,49 +1275,415 @@ class EventList{
 
         //function for printing all the events happening at the venue for a congregation
         void showCalendar(string cname, string inputvenuename, string country){
+            //served from memory if the calendar was already materialized
+            auto vit = calendars.find(venueKey(inputvenuename, country));
+            if(vit != calendars.end()){
+                auto cit = vit->second.find(cname);
+                if(cit != vit->second.end()){
+                    refreshCalendar(cit->second, inputvenuename, country);
+                    cout << cit->second.rendered;
+                    return;
+                }
+            }
             //checks if reservation is present or not
-            int reserved = false;
             string startdate = "";
             string enddate = "";
-            for(auto velement: venues.venuelist){
-                if(velement.name == inputvenuename && velement.country == country){
-                    for(auto relement : velement.reservations){
-                        if(relement.cname == cname){
-                            reserved = true;
-                            startdate = relement.startdate;
-                            enddate = relement.enddate;
-                            break;
+            if(!findReservation(cname, inputvenuename, country, startdate, enddate)){
+                cout << -1 << endl << "Error" << endl;
+                return;
+            }
+            //materialize the schedule for each day of the reservation, later changes only render their own day again
+            CalendarView &view = calendars[venueKey(inputvenuename, country)][cname];
+            view = makeCalendar(startdate, enddate);
+            refreshCalendar(view, inputvenuename, country);
+            cout << view.rendered;
+            return;
+        }
+
+        //function for printing the events of all venues between two dates, walking the eventlist in chronological order
+        void showEventsBetween(string fromdate, string todate){
+            //occurrences of recurring events inside the range are expanded and merged in the same order
+            vector<Event> occurrences;
+            long firstday = dayNumber(fromdate), lastday = dayNumber(todate);
+            for(auto &rules : recurring){
+                size_t split = rules.first.find('\n');
+                string venuename = rules.first.substr(0, split), country = rules.first.substr(split + 1);
+                for(auto &rule : rules.second){
+                    long day = max(rule.firstday, firstday);
+                    day += (rule.step - (day - rule.firstday) % rule.step) % rule.step;
+                    for(; day <= min(rule.lastday, lastday); day += rule.step){
+                        if(rule.occursOn(day)){
+                            occurrences.push_back(Event(rule.cname, venuename, country, rule.eventname, dateFromDayNumber(day), rule.fromhour, rule.tohour));
                         }
                     }
                 }
-                if(reserved){
+            }
+            sort(occurrences.begin(), occurrences.end());
+
+            int count = 0;
+            string toprint = "\n";
+            auto occurrence = occurrences.begin();
+            auto it = eventlist.lower_bound(Event("", "", "", "", fromdate, "", ""));
+            while(true){
+                const Event *element = nullptr;
+                bool inrange = it != eventlist.end() && it->date <= todate;
+                if(inrange && (occurrence == occurrences.end() || *it < *occurrence)){
+                    element = &*it;
+                    it++;
+                }
+                else if(occurrence != occurrences.end()){
+                    element = &*occurrence;
+                    occurrence++;
+                }
+                else{
                     break;
                 }
+                toprint += element->date + " " + element->venuename + " " + element->country + " " + element->eventname + " " + element->fromhour + " " + element->tohour + "\n";
+                count++;
             }
+            cout << count << toprint;
+            return;
+        }
 
-            if(!reserved){
+        //function to print the hours booked at a venue on a day
+        void bookedHours(string venuename, string country, string date){
+            long long minutes = 0;
+            auto vit = bookedminutes.find(venueKey(venuename, country));
+            if(vit != bookedminutes.end()){
+                auto dit = vit->second.find(dayNumber(date));
+                if(dit != vit->second.end()){
+                    minutes = dit->second;
+                }
+            }
+            cout << formatHundredths(minutes * 100 / 60) << endl;
+            return;
+        }
+
+        //function to print the booked, reserved and seat hours of the venues of a country and their utilization in percent
+        void utilization(string country){
+            CountryStats stats;
+            auto it = countrystats.find(country);
+            if(it != countrystats.end()){
+                stats = it->second;
+            }
+            long long reservedminutes = stats.reserveddays * 24 * 60;
+            cout << "booked " << formatHundredths(stats.bookedminutes * 100 / 60) << endl;
+            cout << "reserved " << formatHundredths(reservedminutes * 100 / 60) << endl;
+            cout << "seathours " << formatHundredths(stats.seatminutes * 100 / 60) << endl;
+            cout << "utilization " << formatHundredths(reservedminutes == 0 ? 0 : stats.bookedminutes * 10000 / reservedminutes) << endl;
+            return;
+        }
+
+        //function to print the number of events of congregations of a type between two dates
+        void eventCounts(Type ctype, string fromdate, string todate){
+            cout << typecounts[ctype].count(dayNumber(fromdate), dayNumber(todate)) << endl;
+            return;
+        }
+
+        //function to add an event happening every day or every week of the reservation, stored as a single rule
+        void addRecurringEvent(string cname, string inputvenuename, string country, string rule, string inputfromhour, string inputtohour, string inputeventname){
+            string startdate = "";
+            string enddate = "";
+            const Venue *venue = findReservation(cname, inputvenuename, country, startdate, enddate);
+            if(!venue){
                 cout << -1 << endl << "Error" << endl;
                 return;
             }
-            //print schedule for each day of the reservation
-            int totalcount = 0;
-            string wholetoprint = "\n";
-            for(string i = startdate; i<=enddate ; i = addMinutes(i+"-00:00",24*60).substr(0,10)){
-                int count = 0;
-                string toprint = "\n";
-                for(auto element : eventlist){
-                    if(element.date == i && element.venuename == inputvenuename && element.country == country){
-                        toprint += element.eventname + " " + element.fromhour + " " + element.tohour + "\n";
-                        count++;
-                        totalcount++;
+            RecurringEvent newRule = {cname, inputeventname, inputfromhour, inputtohour, dayNumber(startdate), dayNumber(enddate), rule == "Weekly" ? 7 : 1, {}, congregationType(cname)};
+            //a daily rule running until midnight can be too close to its own occurrence of the next day
+            if(newRule.step == 1 && newRule.firstday < newRule.lastday && eventsClash(startdate, inputfromhour, inputtohour, dateFromDayNumber(newRule.firstday + 1), inputfromhour, inputtohour)){
+                cout << -1 << endl << "Error" << endl;
+                return;
+            }
+            //one sweep over the events checks the occurrences from the day before to the day after each of them,
+            //as events ending at midnight clash with the start of the next day
+            for(auto element : eventsAtVenue(inputvenuename, country)){
+                long eventday = dayNumber(element->date);
+                for(long day = eventday - 1; day <= eventday + 1; day++){
+                    if(newRule.occursOn(day) && eventsClash(dateFromDayNumber(day), inputfromhour, inputtohour, element->date, element->fromhour, element->tohour)){
+                        cout << -1 << endl << "Error" << endl;
+                        return;
+                    }
+                }
+            }
+            //occurrences of the other rules of the venue are only compared from the day before to the day after
+            string venuekey = venueKey(inputvenuename, country);
+            auto rit = recurring.find(venuekey);
+            if(rit != recurring.end()){
+                for(auto &other : rit->second){
+                    for(long day = newRule.firstday; day <= newRule.lastday; day += newRule.step){
+                        for(long otherday = day - 1; otherday <= day + 1; otherday++){
+                            if(other.occursOn(otherday) && eventsClash(dateFromDayNumber(day), inputfromhour, inputtohour, dateFromDayNumber(otherday), other.fromhour, other.tohour)){
+                                cout << -1 << endl << "Error" << endl;
+                                return;
+                            }
+                        }
+                    }
+                }
+            }
+            recurring[venuekey].push_back(newRule);
+            capacities[venuekey] = venue->capacity;
+            countRule(venuekey, country, newRule, 1);
+            invalidateCalendarVenue(inputvenuename, country);
+            cout << 0 << endl;
+            return;
+        }
+
+        //function to delete a recurring event together with all of its occurrences
+        void deleteRecurringEvent(string cname, string inputvenuename, string country, string inputfromhour, string inputeventname){
+            auto rit = recurring.find(venueKey(inputvenuename, country));
+            if(rit != recurring.end()){
+                for(size_t i=0;i<rit->second.size();i++){
+                    if(rit->second[i].cname == cname && rit->second[i].eventname == inputeventname && rit->second[i].fromhour == inputfromhour){
+                        countRule(rit->first, country, rit->second[i], -1);
+                        rit->second.erase(rit->second.begin() + i);
+                        if(rit->second.empty()){
+                            recurring.erase(rit);
+                        }
+                        invalidateCalendarVenue(inputvenuename, country);
+                        cout << 0 << endl;
+                        return;
+                    }
+                }
+            }
+            cout << -1 << endl << "Error" << endl;
+            return;
+        }
+
+        //function to print the memory held by each structure, in bytes
+        void memStats(){
+            size_t eventbytes = 0, reservationbytes = 0, venuebytes = 0, congregationbytes = 0, recurringbytes = 0, calendarbytes = 0, stringbytes = 0, indexbytes = 0;
+            for(auto &element : eventlist){
+                eventbytes += sizeof(Event) + treeNodeBytes;
+                stringbytes += stringBytes(element.eventname) + stringBytes(element.venuename) + stringBytes(element.cname) + stringBytes(element.country) + stringBytes(element.date) + stringBytes(element.fromhour) + stringBytes(element.tohour);
+            }
+            venuebytes += venues.venuelist.capacity() * sizeof(Venue);
+            for(auto &velement : venues.venuelist){
+                stringbytes += stringBytes(velement.name) + stringBytes(velement.address) + stringBytes(velement.city) + stringBytes(velement.state) + stringBytes(velement.postal) + stringBytes(velement.country);
+                reservationbytes += velement.reservations.capacity() * sizeof(Reservation);
+                for(auto &relement : velement.reservations){
+                    stringbytes += stringBytes(relement.cname) + stringBytes(relement.startdate) + stringBytes(relement.enddate);
+                }
+            }
+            congregationbytes += venues.congregations.congregationlist.capacity() * sizeof(Congregation);
+            for(auto &celement : venues.congregations.congregationlist){
+                stringbytes += stringBytes(celement.cname) + stringBytes(celement.cstartdate) + stringBytes(celement.cenddate);
+            }
+            for(auto &rules : recurring){
+                indexbytes += treeNodeBytes + sizeof(rules) + stringBytes(rules.first);
+                recurringbytes += rules.second.capacity() * sizeof(RecurringEvent);
+                for(auto &rule : rules.second){
+                    recurringbytes += rule.cancelled.size() * (sizeof(long) + treeNodeBytes);
+                    stringbytes += stringBytes(rule.cname) + stringBytes(rule.eventname) + stringBytes(rule.fromhour) + stringBytes(rule.tohour);
+                }
+            }
+            indexbytes += venueevents.bucket_count() * sizeof(void*);
+            for(auto &schedule : venueevents){
+                indexbytes += hashNodeBytes + sizeof(schedule) + stringBytes(schedule.first) + schedule.second.size() * (sizeof(const Event*) + treeNodeBytes);
+            }
+            //calendars only cache output, compact gives their memory back
+            for(auto &views : calendars){
+                calendarbytes += treeNodeBytes + sizeof(views) + stringBytes(views.first);
+                for(auto &view : views.second){
+                    calendarbytes += treeNodeBytes + sizeof(view) + stringBytes(view.first) + stringBytes(view.second.rendered);
+                    calendarbytes += view.second.dates.capacity() * sizeof(string) + view.second.days.capacity() * sizeof(string) + view.second.counts.capacity() * sizeof(int) + view.second.dirty.capacity() / 8;
+                    calendarbytes += view.second.dayindex.bucket_count() * sizeof(void*) + view.second.dayindex.size() * (hashNodeBytes + sizeof(pair<string, size_t>));
+                    for(size_t i=0;i<view.second.dates.size();i++){
+                        calendarbytes += stringBytes(view.second.dates[i]) * 2 + stringBytes(view.second.days[i]);
+                    }
+                }
+            }
+            size_t analyticsbytes = capacities.bucket_count() * sizeof(void*) + countrystats.bucket_count() * sizeof(void*) + bookedminutes.bucket_count() * sizeof(void*);
+            for(auto &capacity : capacities){
+                analyticsbytes += hashNodeBytes + sizeof(capacity) + stringBytes(capacity.first);
+            }
+            for(auto &stats : countrystats){
+                analyticsbytes += hashNodeBytes + sizeof(stats) + stringBytes(stats.first);
+            }
+            for(auto &days : bookedminutes){
+                analyticsbytes += hashNodeBytes + sizeof(days) + stringBytes(days.first) + days.second.bucket_count() * sizeof(void*) + days.second.size() * (hashNodeBytes + sizeof(pair<long, int>));
+            }
+            for(auto &counter : typecounts){
+                analyticsbytes += counter.bytes();
+            }
+            size_t total = eventbytes + reservationbytes + venuebytes + congregationbytes + recurringbytes + calendarbytes + stringbytes + indexbytes + analyticsbytes;
+            cout << total << endl;
+            cout << "events " << eventbytes << endl;
+            cout << "reservations " << reservationbytes << endl;
+            cout << "venues " << venuebytes << endl;
+            cout << "congregations " << congregationbytes << endl;
+            cout << "recurring " << recurringbytes << endl;
+            cout << "calendars " << calendarbytes << endl;
+            cout << "strings " << stringbytes << endl;
+            cout << "indexes " << indexbytes << endl;
+            cout << "analytics " << analyticsbytes << endl;
+            return;
+        }
+
+        //function to give back the memory kept after deletions, every list is reallocated to its size in one pass
+        void compact(){
+            venues.venuelist.shrink_to_fit();
+            for(auto &velement : venues.venuelist){
+                velement.reservations.shrink_to_fit();
+            }
+            venues.congregations.congregationlist.shrink_to_fit();
+            for(auto &rules : recurring){
+                rules.second.shrink_to_fit();
+            }
+            venueevents.rehash(0);
+            //a capacity is only needed to take back the seat hours of the events and recurring events still in memory
+            for(auto it = capacities.begin(); it != capacities.end();){
+                auto rit = recurring.find(it->first);
+                if(venueevents.count(it->first) == 0 && (rit == recurring.end() || rit->second.empty())){
+                    it = capacities.erase(it);
+                }
+                else{
+                    it++;
+                }
+            }
+            capacities.rehash(0);
+            for(auto &days : bookedminutes){
+                days.second.rehash(0);
+            }
+            bookedminutes.rehash(0);
+            for(auto it = countrystats.begin(); it != countrystats.end();){
+                if(it->second.bookedminutes == 0 && it->second.seatminutes == 0 && it->second.reserveddays == 0){
+                    it = countrystats.erase(it);
+                }
+                else{
+                    it++;
+                }
+            }
+            countrystats.rehash(0);
+            //calendars are rendered again on their next showCalendar
+            calendars.clear();
+#ifdef __GLIBC__
+            malloc_trim(0);
+#endif
+            cout << 0 << endl;
+            return;
+        }
+
+        //function called before every command, once a minute it checks for a new day and archives what is now in the past
+        void archiveIfDue(){
+            if(archivedir.empty()){
+                return;
+            }
+            time_t now = time(nullptr);
+            if(now < nextarchivecheck){
+                return;
+            }
+            nextarchivecheck = now + 60;
+            long today = todayNumber();
+            if(today > archivedthrough){
+                sweepArchive(today);
+            }
+        }
+
+        //function to archive the past events and reservations now instead of at the next new day
+        void archive(){
+            if(archivedir.empty() || !sweepArchive(todayNumber())){
+                cout << -1 << endl << "Error" << endl;
+                return;
+            }
+            cout << 0 << endl;
+            return;
+        }
+
+        //function to print the events of a venue between two dates, archived or not, in chronological order
+        void showHistory(string venuename, string country, string fromdate, string todate){
+            //an event is identified by its line, which is prefixed by the day and start time to keep the output chronological.
+            //Copies left in the archive by an interrupted sweep are dropped, and an event still in memory replaces its archived copy
+            map<string, string> lines;//line of each event, keyed by day, start time and the line itself
+            long firstday = dayNumber(fromdate), lastday = dayNumber(todate);
+            auto line = [](const string& date, const string& eventname, const string& fromhour, const string& tohour){
+                return date + " " + eventname + " " + fromhour + " " + tohour + "\n";
+            };
+            //only the segments of the months in the range are read
+            int firstyear = 0, firstmonth = 0, lastyear = 0, lastmonth = 0;
+            sscanf(monthOf(fromdate).c_str(), "%d-%d", &firstyear, &firstmonth);
+            sscanf(monthOf(todate).c_str(), "%d-%d", &lastyear, &lastmonth);
+            for(int month = firstyear * 12 + firstmonth - 1; !archivedir.empty() && month <= lastyear * 12 + lastmonth - 1; month++){
+                char segment[32];
+                snprintf(segment, sizeof(segment), "/events-%04d-%02d.seg", month / 12, month % 12 + 1);
+                for(auto &record : readSegment(archivedir + segment)){
+                    vector<string> f = splitstring(record, recordSeparator);
+                    if(f.size() == 8 && f[1] == country && f[2] == venuename && dayNumber(f[0]) >= firstday && dayNumber(f[0]) <= lastday){
+                        string text = line(f[0], f[6], f[3], f[4]);
+                        lines.emplace(f[0] + f[3] + text, text);
+                    }
+                }
+            }
+            auto addElement = [&](const Event *element){
+                long day = dayNumber(element->date);
+                if(day >= firstday && day <= lastday){
+                    string text = line(element->date, element->eventname, element->fromhour, element->tohour);
+                    lines[element->date + element->fromhour + text] = text;
+                }
+            };
+            for(auto element : eventsAtVenue(venuename, country)){
+                addElement(element);
+            }
+            auto rit = recurring.find(venueKey(venuename, country));
+            if(rit != recurring.end()){
+                for(auto &rule : rit->second){
+                    long day = max(rule.firstday, firstday);
+                    day += (rule.step - (day - rule.firstday) % rule.step) % rule.step;
+                    for(; day <= min(rule.lastday, lastday); day += rule.step){
+                        if(rule.occursOn(day)){
+                            string date = dateFromDayNumber(day);
+                            string text = line(date, rule.eventname, rule.fromhour, rule.tohour);
+                            lines[date + rule.fromhour + text] = text;
+                        }
                     }
                 }
-                wholetoprint += i + " " + to_string(count) + toprint;
             }
-            cout << totalcount << wholetoprint;
+            string toprint = "\n";
+            for(auto &entry : lines){
+                toprint += entry.second;
+            }
+            cout << lines.size() << toprint;
             return;
         }
 
+        //function to print the archived reservations of a congregation, in the order they ended
+        void showReservationHistory(string cname){
+            if(archivedir.empty()){
+                cout << -1 << endl << "Error" << endl;
+                return;
+            }
+            vector<string> segments;
+            error_code ec;
+            for(filesystem::directory_iterator it(archivedir, ec), end; !ec && it != end; it.increment(ec)){
+                string name = it->path().filename().string();
+                if(name.rfind("reservations-", 0) == 0){
+                    segments.push_back(it->path().string());
+                }
+            }
+            sort(segments.begin(), segments.end());
+            set<pair<string, string>> lines;//end date and line of each reservation, copies left by an interrupted sweep are dropped
+            for(auto &segment : segments){
+                for(auto &record : readSegment(segment)){
+                    vector<string> f = splitstring(record, recordSeparator);
+                    if(f.size() == 5 && f[2] == cname){
+                        lines.insert({f[4], f[0] + " " + f[1] + " " + f[3] + " " + f[4] + "\n"});
+                    }
+                }
+            }
+            string toprint = "\n";
+            for(auto &line : lines){
+                toprint += line.second;
+            }
+            cout << lines.size() << toprint;
+            return;
+        }
+
+        //function to allocate the lists once before a bulk load instead of growing them item by item
+        void reserveCapacity(size_t venuecount, size_t congregationcount){
+            venues.venuelist.reserve(venues.venuelist.size() + venuecount);
+            venues.congregations.congregationlist.reserve(venues.congregations.congregationlist.size() + congregationcount);
+        }
+
         //function for redirecting to addVenue
         void addVenueToVenues(string venuename, string address, string city, string state, string postal, string country, int venuecapacity){
             venues.addVenue(venuename, address, city , state, postal, country, venuecapacity);
@@ -636,21 +1705,32 @@ class EventList{
         //all the following fuctions below is used for redirecting
 
         void reserveVenueFromVenues(string venuename, string country, string cname){
-            venues.reserveVenue(venuename, country, cname);
+            if(venues.reserveVenue(venuename, country, cname)){
+                string startdate, enddate;
+                findReservation(cname, venuename, country, startdate, enddate);
+                countReservation(country, startdate, enddate, 1);
+            }
             return;
         }
 
         void freeVenueFromVenues(string venuename, string country, string cname){
             //delete all the events of that congregation on the venue
-            for(size_t i=0;i<eventlist.size();){
-                if(eventlist[i].venuename == venuename && eventlist[i].country == country && eventlist[i].cname == cname){
-                    eventlist.erase(eventlist.begin() + i);
-                }
-                else{
-                    i++;
+            vector<const Event*> toerase;
+            for(auto element : eventsAtVenue(venuename, country)){
+                if(element->cname == cname){
+                    toerase.push_back(element);
                 }
             }
-            venues.freeVenue(venuename, country, cname);
+            for(auto element : toerase){
+                eraseEvent(eventlist.find(*element));
+            }
+            dropRecurring(cname, venueKey(venuename, country));
+            dropCalendar(cname, venuename, country);
+            string startdate, enddate;
+            findReservation(cname, venuename, country, startdate, enddate);
+            if(venues.freeVenue(venuename, country, cname)){
+                countReservation(country, startdate, enddate, -1);
+            }
             return;
         }
 
@@ -659,17 +1739,36 @@ class EventList{
             return;
         }
 
-        void addCongregationToCongregations(string inputname, string inputtype, string inputstartdate, string inputenddate){
+        void addCongregationToCongregations(string inputname, Type inputtype, string inputstartdate, string inputenddate){
             venues.congregations.addCongregation(inputname, inputtype, inputstartdate, inputenddate);
         }
 
         void deleteCongregationFromCongregationsByVenues(string inputname){
-            for(size_t i=0;i<eventlist.size();){
-                if(eventlist[i].cname == inputname){
-                    eventlist.erase(eventlist.begin() + i);
+            for(auto it = eventlist.begin(); it != eventlist.end();){
+                if(it->cname == inputname){
+                    it = eraseEvent(it);
+                }
+                else{
+                    it++;
+                }
+            }
+            dropRecurring(inputname, "");
+            //the reservations of the congregation are deleted as well, so are their calendars
+            for(auto vit = calendars.begin(); vit != calendars.end();){
+                vit->second.erase(inputname);
+                if(vit->second.empty()){
+                    vit = calendars.erase(vit);
                 }
                 else{
-                    i++;
+                    vit++;
+                }
+            }
+            for(auto &velement : venues.venuelist){
+                for(auto &relement : velement.reservations){
+                    if(relement.cname == inputname){
+                        countReservation(velement.country, relement.startdate, relement.enddate, -1);
+                        break;
+                    }
                 }
             }
             venues.deleteCongregationFromCongregations(inputname);
@@ -682,201 +1781,755 @@ class EventList{
         }
 };
 
-int main(){
-    EventList events;
-    string input;
-    while (getline(cin, input)){
+//commands understood by the scheduler, the order matches commandNames
+enum class CommandId {AddCongregation, DeleteCongregation, ShowCongregations, AddVenue, DeleteVenue, ShowVenues, ReserveVenue, FreeVenue, ShowReserved,
+    AddEvent, AddRecurringEvent, DeleteEvent, DeleteRecurringEvent, ShowEvents, ShowCalendar, ShowEventsBetween, BookedHours, Utilization,
+    EventCounts, MemStats, Compact, Archive, ShowHistory, ShowReservationHistory, End, Count};
+constexpr int commandCount = static_cast<int>(CommandId::Count);
+
+constexpr string_view commandNames[commandCount] = {"addCongregation", "deleteCongregation", "showCongregations", "addVenue", "deleteVenue", "showVenues", "reserveVenue", "freeVenue", "showReserved",
+    "addEvent", "addRecurringEvent", "deleteEvent", "deleteRecurringEvent", "showEvents", "showCalendar", "showEventsBetween", "bookedHours", "utilization",
+    "eventCounts", "memstats", "compact", "archive", "showHistory", "showReservationHistory", "End"};
+
+//fnv-1a hash of a command name, folded into the slots of the command table
+constexpr size_t commandSlots = 131;
+constexpr size_t commandSlot(string_view name){
+    uint32_t hash = 2166136261u;
+    for (char ch : name){
+        hash = (hash ^ static_cast<unsigned char>(ch)) * 16777619u;
+    }
+    return hash % commandSlots;
+}
 
-        istringstream iss(input);
-        string command;
-        iss >> command;
+//table from slot to command, built at compile time
+constexpr array<int8_t, commandSlots> buildCommandTable(){
+    array<int8_t, commandSlots> table{};
+    for (auto &slot : table){
+        slot = -1;
+    }
+    for (int id = 0; id < commandCount; id++){
+        table[commandSlot(commandNames[id])] = id;
+    }
+    return table;
+}
+constexpr array<int8_t, commandSlots> commandTable = buildCommandTable();
 
-        if (command == "addCongregation"){
-            string name, inputtype, startdate, enddate;
-            // Parse each field using readQuotedString
-            if (!readQuotedString(iss, name) || !readQuotedString(iss, inputtype) || !readQuotedString(iss, startdate) || !readQuotedString(iss, enddate)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if (inputtype != "Concert" && inputtype != "Games" && inputtype != "Convention" && inputtype != "Conference") {
-                cout << "-1" << endl << "Error" << endl;
-                continue;
-            }
-            if (!name.empty() && !inputtype.empty() && !startdate.empty() && !enddate.empty() && isValidAndFutureDate(startdate) && isValidAndFutureDate(enddate) && startdate <= enddate) {
-                events.addCongregationToCongregations(name, inputtype, startdate, enddate);
-            } else {
-                cout << -1 << endl << "Error" << endl;
-            }
+constexpr bool commandTableIsPerfect(){
+    for (int id = 0; id < commandCount; id++){
+        if (commandTable[commandSlot(commandNames[id])] != id){
+            return false;
         }
+    }
+    return true;
+}
+static_assert(commandTableIsPerfect(), "two commands share a slot of the command table, change commandSlots");
 
-        else if (command == "deleteCongregation"){
-            string name;
-            if (!readQuotedString(iss, name)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
+//function to find a command by name, one hash and one compare, -1 for unknown commands
+int findCommand(string_view name){
+    int id = commandTable[commandSlot(name)];
+    return id >= 0 && commandNames[id] == name ? id : -1;
+}
+
+//structure for an input line after tokenizing and validating it, before it is applied to the eventlist
+struct ParsedCommand{
+    int id = -1;//unknown commands are ignored
+    vector<string> fields;
+    int number = 0;//capacity of addVenue or type of addCongregation and eventCounts
+    bool valid = false;//invalid commands only print the error
+};
+
+//parser for commands whose fields are all quoted strings, Check validates the fields once all of them are read
+template<size_t N, bool (*Check)(ParsedCommand&)>
+bool parseQuoted(istringstream &iss, ParsedCommand &parsed){
+    parsed.fields.resize(N);
+    for (auto &field : parsed.fields){
+        if (!readQuotedString(iss, field)) {
+            return false;
+        }
+    }
+    return Check(parsed);
+}
+
+//check that the listed fields are not empty
+template<size_t... Fields>
+bool nonEmpty(ParsedCommand &parsed){
+    return (!parsed.fields[Fields].empty() && ...);
+}
+
+bool checkCongregation(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    Type ctype = Concert;
+    if (!stringToType(f[1], ctype)) {
+        return false;
+    }
+    parsed.number = ctype;
+    return !f[0].empty() && !f[2].empty() && !f[3].empty() && isValidAndFutureDate(f[2]) && isValidAndFutureDate(f[3]) && f[2] <= f[3];
+}
+
+//cname, venuename, country, date or rule, fromhour, tohour, eventname
+template<bool Recurring>
+bool checkEvent(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    bool when = Recurring ? (f[3] == "Daily" || f[3] == "Weekly") : isValidAndFutureDate(f[3]);
+    return !f[1].empty() && !f[6].empty() && when && isValidTime(f[4]) && isValidTime(f[5]) &&  (addMinutes("2024-01-01-"+f[4], 30).substr(11,5)<=f[5] || (f[5] == "00:00" && f[4]<="23:30"));
+}
+
+//cname, venuename, country, date, fromhour, eventname
+bool checkDeleteEvent(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    return !f[1].empty() && !f[5].empty() && isValidAndFutureDate(f[3]) && isValidTime(f[4]);
+}
+
+//cname, venuename, country, fromhour, eventname
+bool checkDeleteRecurringEvent(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    return !f[1].empty() && !f[4].empty() && isValidTime(f[3]);
+}
+
+bool checkShowEvents(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    return !f[0].empty() && !f[1].empty() && isValidAndFutureDate(f[2]);
+}
+
+bool checkDateRange(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    int year, month, day;
+    return parseDate(f[0], year, month, day) && parseDate(f[1], year, month, day) && f[0] <= f[1];
+}
+
+//venuename, country, fromdate, todate, the dates may be in the past
+bool checkHistory(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    int year, month, day;
+    return !f[0].empty() && !f[1].empty() && parseDate(f[2], year, month, day) && parseDate(f[3], year, month, day) && dayNumber(f[2]) <= dayNumber(f[3]);
+}
+
+bool checkBookedHours(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    int year, month, day;
+    return !f[0].empty() && !f[1].empty() && parseDate(f[2], year, month, day);
+}
+
+bool checkEventCounts(ParsedCommand &parsed){
+    const vector<string> &f = parsed.fields;
+    int year, month, day;
+    Type ctype = Concert;
+    if (!stringToType(f[0], ctype)) {
+        return false;
+    }
+    parsed.number = ctype;
+    return parseDate(f[1], year, month, day) && parseDate(f[2], year, month, day) && f[1] <= f[2];
+}
+
+bool parseAddVenue(istringstream &iss, ParsedCommand &parsed){
+    string venuelocation;
+    vector<string> &f = parsed.fields;
+    f.resize(1);
+    if (!readQuotedString(iss, f[0]) || !readQuotedString(iss, venuelocation) || !(iss >> parsed.number)) {
+        return false;
+    }
+    vector<string> loc = splitstring(venuelocation, ':');
+    if (loc.size() < 5){
+        return false;
+    }
+    f.insert(f.end(), loc.begin(), loc.begin() + 5);
+    return !f[0].empty() && !loc[0].empty() && !loc[1].empty() && !loc[2].empty() && !loc[3].empty() && !loc[4].empty() && parsed.number > 0;
+}
+
+bool parseShowVenues(istringstream &iss, ParsedCommand &parsed){
+    string loc;
+    vector<string> &f = parsed.fields;
+    if (!readQuotedString(iss, loc)) {
+        return false;
+    }
+    f = splitstring(loc, ':');
+    if (f.size() < 4){
+        return false;
+    }
+    f.resize(4);
+    return !f[3].empty() && (f[0].empty() ? true:!f[1].empty());
+}
+
+//number of arguments of a method of the eventlist
+template<typename... Args>
+constexpr size_t methodArity(void (EventList::*)(Args...)){
+    return sizeof...(Args);
+}
+
+//applies a command by calling a method of the eventlist with the fields as its arguments
+template<typename... Args, size_t... I>
+void callWithFields(EventList &events, void (EventList::*method)(Args...), const vector<string>& f, index_sequence<I...>){
+    (events.*method)(f[I]...);
+}
+
+template<auto Method>
+void applyFields(EventList &events, const ParsedCommand &parsed){
+    callWithFields(events, Method, parsed.fields, make_index_sequence<methodArity(Method)>());
+}
+
+//entry of the command registry, the parser and the action of a command
+struct CommandSpec{
+    bool (*parse)(istringstream&, ParsedCommand&);
+    void (*apply)(EventList&, const ParsedCommand&);
+};
+
+//registry of the commands, indexed by CommandId
+constexpr CommandSpec commandSpecs[commandCount] = {
+    {parseQuoted<4, checkCongregation>, [](EventList &events, const ParsedCommand &parsed){
+        events.addCongregationToCongregations(parsed.fields[0], static_cast<Type>(parsed.number), parsed.fields[2], parsed.fields[3]);
+    }},
+    {parseQuoted<1, nonEmpty<0>>, applyFields<&EventList::deleteCongregationFromCongregationsByVenues>},
+    {parseQuoted<0, nonEmpty<>>, applyFields<&EventList::showCongregationFromCongregations>},
+    {parseAddVenue, [](EventList &events, const ParsedCommand &parsed){
+        const vector<string> &f = parsed.fields;
+        events.addVenueToVenues(f[0], f[1], f[2], f[3], f[4], f[5], parsed.number);
+    }},
+    {parseQuoted<2, nonEmpty<0, 1>>, applyFields<&EventList::deleteVenueFromVenues>},
+    {parseShowVenues, applyFields<&EventList::showVenuesFromVenues>},
+    {parseQuoted<3, nonEmpty<0, 1, 2>>, applyFields<&EventList::reserveVenueFromVenues>},
+    {parseQuoted<3, nonEmpty<0, 1, 2>>, applyFields<&EventList::freeVenueFromVenues>},
+    {parseQuoted<1, nonEmpty<0>>, applyFields<&EventList::showReservedVenueFromVenues>},
+    {parseQuoted<7, checkEvent<false>>, applyFields<&EventList::addEvent>},
+    {parseQuoted<7, checkEvent<true>>, applyFields<&EventList::addRecurringEvent>},
+    {parseQuoted<6, checkDeleteEvent>, applyFields<&EventList::deleteEvent>},
+    {parseQuoted<5, checkDeleteRecurringEvent>, applyFields<&EventList::deleteRecurringEvent>},
+    {parseQuoted<3, checkShowEvents>, applyFields<&EventList::showEvents>},
+    {parseQuoted<3, nonEmpty<0, 1, 2>>, applyFields<&EventList::showCalendar>},
+    {parseQuoted<2, checkDateRange>, applyFields<&EventList::showEventsBetween>},
+    {parseQuoted<3, checkBookedHours>, applyFields<&EventList::bookedHours>},
+    {parseQuoted<1, nonEmpty<0>>, applyFields<&EventList::utilization>},
+    {parseQuoted<3, checkEventCounts>, [](EventList &events, const ParsedCommand &parsed){
+        events.eventCounts(static_cast<Type>(parsed.number), parsed.fields[1], parsed.fields[2]);
+    }},
+    {parseQuoted<0, nonEmpty<>>, applyFields<&EventList::memStats>},
+    {parseQuoted<0, nonEmpty<>>, applyFields<&EventList::compact>},
+    {parseQuoted<0, nonEmpty<>>, applyFields<&EventList::archive>},
+    {parseQuoted<4, checkHistory>, applyFields<&EventList::showHistory>},
+    {parseQuoted<1, nonEmpty<0>>, applyFields<&EventList::showReservationHistory>},
+    {parseQuoted<0, nonEmpty<>>, nullptr},
+};
+
+//function that tokenizes and validates one input line, it does not touch the eventlist so lines can be parsed in parallel
+ParsedCommand parseLine(const string& input){
+    ParsedCommand parsed;
+    istringstream iss(input);
+    string command;
+    iss >> command;
+    parsed.id = findCommand(command);
+    if (parsed.id >= 0){
+        parsed.valid = commandSpecs[parsed.id].parse(iss, parsed);
+    }
+    return parsed;
+}
+
+//function that applies a parsed command to the eventlist, returns false once the input is over
+bool applyCommand(EventList &events, const ParsedCommand& parsed){
+    if (parsed.id < 0){
+        return true;
+    }
+    if (!parsed.valid){
+        cout << -1 << endl << "Error" << endl;
+        return true;
+    }
+    if (parsed.id == static_cast<int>(CommandId::End)){
+        return false;
+    }
+    events.archiveIfDue();
+    commandSpecs[parsed.id].apply(events, parsed);
+    return true;
+}
+
+//results of loading a command file
+enum class LoadResult {Loaded, Ended, Failed};
+
+//function for cold loading a command file, the file is memory mapped and parsed in parallel chunks, then applied in input order
+//so the state and the outputs are the same as piping the file through the input. Ended means the file ended the program,
+//Failed that it could not be read
+LoadResult loadFile(EventList &events, const string& path){
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0){
+        cerr << "cannot open " << path << endl;
+        if (fd >= 0) close(fd);
+        return LoadResult::Failed;
+    }
+    size_t size = st.st_size;
+    if (size == 0){
+        close(fd);
+        return LoadResult::Loaded;
+    }
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED){
+        cerr << "cannot map " << path << endl;
+        return LoadResult::Failed;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    const char *data = static_cast<const char*>(mapped);
+    const char *end = data + size;
+
+    //counting the entities first lets the lists be allocated once instead of growing while loading
+    size_t venuecount = 0, congregationcount = 0;
+    for (const char *line = data; line < end;){
+        const char *next = static_cast<const char*>(memchr(line, '\n', end - line));
+        next = next ? next + 1 : end;
+        if (next - line > 8 && memcmp(line, "addVenue", 8) == 0) venuecount++;
+        else if (next - line > 15 && memcmp(line, "addCongregation", 15) == 0) congregationcount++;
+        line = next;
+    }
+    events.reserveCapacity(venuecount, congregationcount);
+
+    //the file is handled in windows so that only a bounded number of parsed lines is held in memory at once
+    size_t threads = max(1u, thread::hardware_concurrency());
+    const size_t chunksize = 1 << 22;
+    bool running = true;
+    for (const char *window = data; window < end && running;){
+        //split the window into one chunk per thread, every chunk ends at a line break
+        vector<pair<const char*, const char*>> chunks;
+        const char *chunkstart = window;
+        for (size_t t = 0; t < threads && chunkstart < end; t++){
+            const char *chunkend = chunkstart + min(chunksize, (size_t)(end - chunkstart));
+            if (chunkend < end){
+                const char *newline = static_cast<const char*>(memchr(chunkend, '\n', end - chunkend));
+                chunkend = newline ? newline + 1 : end;
+            }
+            chunks.push_back({chunkstart, chunkend});
+            chunkstart = chunkend;
+        }
+        window = chunkstart;
+
+        vector<vector<ParsedCommand>> parsed(chunks.size());
+        vector<thread> workers;
+        for (size_t t = 0; t < chunks.size(); t++){
+            workers.emplace_back([&parsed, &chunks, t](){
+                for (const char *line = chunks[t].first; line < chunks[t].second;){
+                    const char *next = static_cast<const char*>(memchr(line, '\n', chunks[t].second - line));
+                    const char *lineend = next ? next : chunks[t].second;
+                    parsed[t].push_back(parseLine(string(line, lineend)));
+                    line = next ? next + 1 : chunks[t].second;
+                }
+            });
+        }
+        for (auto &worker : workers){
+            worker.join();
+        }
+        for (auto &chunk : parsed){
+            for (auto &command : chunk){
+                if (!applyCommand(events, command)){
+                    running = false;
+                    break;
+                }
             }
-            if (!name.empty()) {
-                events.deleteCongregationFromCongregationsByVenues(name);
+            if (!running){
+                break;
             }
-            else{
-                cout << -1 << endl << "Error" << endl;
+        }
+    }
+    munmap(mapped, size);
+    return running ? LoadResult::Loaded : LoadResult::Ended;
+}
+
+//lock-free ring buffer between exactly one producing thread and one consuming thread. pushWait and popWait spin for a
+//short while and then sleep, so an idle stage does not keep a core busy
+template<typename T, size_t Capacity>
+class SpscRing{
+    private:
+        static const int spins = 64;//tries before going to sleep
+        vector<T> slots;
+        alignas(64) atomic<size_t> head{0};//next slot to read, only moved by the consumer
+        alignas(64) atomic<size_t> tail{0};//next slot to write, only moved by the producer
+        alignas(64) atomic<int> sleepers{0};//threads sleeping on changed
+        mutex lock;
+        condition_variable changed;
+
+        //wakes the other side up if it is sleeping, the fence orders the moved head or tail before reading sleepers
+        void wake(){
+            atomic_thread_fence(memory_order_seq_cst);
+            if (sleepers.load(memory_order_relaxed) > 0){
+                lock_guard<mutex> guard(lock);
+                changed.notify_all();
             }
         }
 
-        else if (command == "showCongregations"){
-            events.showCongregationFromCongregations();
+        //spins and then sleeps until attempt succeeds, attempt is push or pop
+        template<typename Attempt>
+        void wait(Attempt attempt){
+            for (int i = 0; i < spins; i++){
+                if (attempt()){
+                    wake();
+                    return;
+                }
+                this_thread::yield();
+            }
+            unique_lock<mutex> guard(lock);
+            sleepers.fetch_add(1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            changed.wait(guard, attempt);
+            sleepers.fetch_sub(1, memory_order_relaxed);
+            guard.unlock();
+            wake();
         }
 
-        else if (command == "addVenue"){
-            string venuename, venuelocation;
-            int venuecapacity;
+    public:
+        SpscRing() : slots(Capacity){
+        }
 
-            if (!readQuotedString(iss, venuename) || !readQuotedString(iss, venuelocation) || !(iss >> venuecapacity)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
+        bool push(T &value){
+            size_t t = tail.load(memory_order_relaxed);
+            if (t - head.load(memory_order_acquire) == Capacity){
+                return false;
             }
+            slots[t % Capacity] = move(value);
+            tail.store(t + 1, memory_order_release);
+            return true;
+        }
 
-            vector<string> loc = splitstring(venuelocation, ':');
-            if (!venuename.empty() && !loc[0].empty() && !loc[1].empty() && !loc[2].empty() && !loc[3].empty() && !loc[4].empty() && venuecapacity > 0) {
-                events.addVenueToVenues(venuename, loc[0], loc[1], loc[2], loc[3], loc[4], venuecapacity);
-            } 
-            else {
-                cout << -1 << endl << "Error" << endl;
+        bool pop(T &value){
+            size_t h = head.load(memory_order_relaxed);
+            if (h == tail.load(memory_order_acquire)){
+                return false;
             }
+            value = move(slots[h % Capacity]);
+            head.store(h + 1, memory_order_release);
+            return true;
         }
 
-        else if (command == "deleteVenue"){
-            string venuename, country;
-            if (!readQuotedString(iss, venuename) || !readQuotedString(iss, country)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if (!venuename.empty() && !country.empty()){
-                events.deleteVenueFromVenues(venuename, country);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
-            }
+        bool empty() const{
+            return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
         }
-        
-        else if (command == "showVenues"){
-            string loc;
-            if (!readQuotedString(iss, loc)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
 
-            vector<string> location = splitstring(loc, ':');
-            if(!location[3].empty() && (location[0].empty() ? true:!location[1].empty())){
-                events.showVenuesFromVenues(location[0], location[1], location[2], location[3]);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl; 
-            }
+        void pushWait(T &value){
+            wait([&](){ return push(value); });
         }
 
-        else if (command == "reserveVenue"){
-            string venuename, country, cname;
-            if (!readQuotedString(iss, venuename) || !readQuotedString(iss, country) || !readQuotedString(iss, cname)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if(!venuename.empty() && !country.empty() && !cname.empty()){
-                events.reserveVenueFromVenues(venuename, country, cname);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
-            }
+        void popWait(T &value){
+            wait([&](){ return pop(value); });
         }
+};
 
-        else if (command == "freeVenue"){
-            string venuename, country, cname;
-            if (!readQuotedString(iss, venuename) || !readQuotedString(iss, country) || !readQuotedString(iss, cname)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
+//structure for the output of a batch of commands, passed from the executing stage to the writing stage
+struct Response{
+    string text;
+    bool last = false;//the input is over after this batch
+};
+
+//function for running the input through three stages on their own threads: tokenizing, applying the commands to the
+//eventlist and writing the responses, the stages overlap on different cores and the output stays in input order
+void runPipeline(EventList &events){
+    //reading the input must not flush cout, which belongs to the executing stage
+    cin.tie(nullptr);
+    streambuf *output = cout.rdbuf();
+    auto commands = make_unique<SpscRing<ParsedCommand, 4096>>();
+    auto responses = make_unique<SpscRing<Response, 4096>>();
+
+    thread tokenizer([&](){
+        string input;
+        ParsedCommand parsed;
+        bool running = true;
+        while (running){
+            if (getline(cin, input)){
+                parsed = parseLine(input);
             }
-            if(!venuename.empty() && !country.empty() && !cname.empty()){
-                events.freeVenueFromVenues(venuename, country, cname);
+            else {
+                parsed = ParsedCommand();
+                parsed.id = static_cast<int>(CommandId::End);
+                parsed.valid = true;
             }
-            else{
-                cout << -1 << endl << "Error" << endl;
+            running = !(parsed.id == static_cast<int>(CommandId::End) && parsed.valid);
+            commands->pushWait(parsed);
+        }
+    });
+
+    //the output of the commands is handed over in batches, a batch ends when no command is waiting or it is large
+    thread executor([&](){
+        const size_t batchsize = 1 << 16;
+        ostringstream captured;
+        cout.rdbuf(captured.rdbuf());
+        ParsedCommand parsed;
+        Response response;
+        while (!response.last){
+            commands->popWait(parsed);
+            response.last = !applyCommand(events, parsed);
+            if (response.last || commands->empty() || captured.tellp() >= (streamoff)batchsize){
+                response.text = captured.str();
+                captured.str("");
+                responses->pushWait(response);
             }
         }
+        cout.rdbuf(output);
+    });
+
+    ostream out(output);
+    Response response;
+    while (!response.last){
+        responses->popWait(response);
+        out << response.text;
+    }
+    out.flush();
+    tokenizer.join();
+    executor.join();
+}
 
-        else if (command == "showReserved"){
-            string cname;
-            if (!readQuotedString(iss, cname)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if(!cname.empty()){
-                events.showReservedVenueFromVenues(cname);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
-            }
+
+//function that runs the lines of a command log through an engine and keeps the output of every line, apply returns false
+//once the input is over
+template<typename Apply>
+vector<string> runLog(const vector<string>& lines, Apply apply, double &seconds){
+    vector<string> outputs;
+    outputs.reserve(lines.size());
+    ostringstream captured;
+    streambuf *original = cout.rdbuf(captured.rdbuf());
+    auto start = chrono::steady_clock::now();
+    for (auto &line : lines){
+        bool running = apply(line);
+        outputs.push_back(captured.str());
+        captured.str("");
+        if (!running){
+            break;
         }
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(original);
+    return outputs;
+}
 
-        else if (command == "addEvent"){
-            string cname, venuename, eventname, country;
-            string date, fromhour, tohour;
-            if (!readQuotedString(iss, cname) || !readQuotedString(iss, venuename) || !readQuotedString(iss, country) || !readQuotedString(iss, date) || !readQuotedString(iss, fromhour) || !readQuotedString(iss, tohour) || !readQuotedString(iss, eventname)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
+//commands added after the reference engine, their outputs are not compared. The changed ones also change the state
+//of the fast engine only, so the outputs after them may differ
+const set<string> newCommands = {"addRecurringEvent", "deleteRecurringEvent", "showEventsBetween", "bookedHours", "utilization", "eventCounts",
+    "memstats", "compact", "archive", "showHistory", "showReservationHistory"};
+const set<string> changedCommands = {"addRecurringEvent", "deleteRecurringEvent", "archive"};
+
+//function for replaying a command log through the reference engine of reference_engine.h and through the fast engine,
+//the outputs of every command are compared line by line, returns the number of commands whose output differs
+int replayLog(const string& path){
+    ifstream file(path);
+    if (!file){
+        cerr << "cannot open " << path << endl;
+        return -1;
+    }
+    vector<string> lines;
+    string line;
+    while (getline(file, line)){
+        lines.push_back(line);
+    }
+    double referenceseconds, fastseconds;
+    reference::EventList referenceevents;
+    vector<string> expected = runLog(lines, [&](const string& input){
+        return reference::applyLine(referenceevents, input);
+    }, referenceseconds);
+    EventList events;
+    vector<string> actual = runLog(lines, [&](const string& input){
+        return applyCommand(events, parseLine(input));
+    }, fastseconds);
 
-            if (!venuename.empty() && !eventname.empty() && isValidAndFutureDate(date) && isValidTime(fromhour) && isValidTime(tohour) &&  (addMinutes("2024-01-01-"+fromhour, 30).substr(11,5)<=tohour || (tohour == "00:00" && fromhour<="23:30"))) {
-                events.addEvent(cname, venuename, country, date, fromhour, tohour, eventname);
-            }
-            else {
-                cout << -1 << endl << "Error" << endl;
-            }
+    int mismatches = 0, notcompared = 0, changed = 0;
+    for (size_t i = 0; i < max(expected.size(), actual.size()); i++){
+        string command;
+        istringstream(i < lines.size() ? lines[i] : "") >> command;
+        if (newCommands.count(command)){
+            notcompared++;
+            changed += changedCommands.count(command);
+            continue;
         }
-        
-        else if (command == "deleteEvent"){
-            string cname, venuename, eventname, country;
-            string date, fromhour;
-            if (!readQuotedString(iss, cname) || !readQuotedString(iss, venuename) || !readQuotedString(iss, country) || !readQuotedString(iss, date) || !readQuotedString(iss, fromhour) || !readQuotedString(iss, eventname)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if (!venuename.empty() && !eventname.empty() && isValidAndFutureDate(date) && isValidTime(fromhour)){
-                events.deleteEvent(cname, venuename, country, date, fromhour, eventname);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
-            }
+        string reference = i < expected.size() ? expected[i] : "";
+        string fast = i < actual.size() ? actual[i] : "";
+        if (reference == fast){
+            continue;
         }
-        
-        else if (command == "showEvents"){
-            string venuename, country, date;
-            if (!readQuotedString(iss, venuename) || !readQuotedString(iss, country) || !readQuotedString(iss, date)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if (!venuename.empty() && !country.empty() && isValidAndFutureDate(date)){
-                events.showEvents(venuename, country, date);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
+        mismatches++;
+        if (mismatches > 10){
+            continue;
+        }
+        //print the first output line where the engines part
+        istringstream referencelines(reference), fastlines(fast);
+        string referenceline, fastline;
+        while (true){
+            bool morereference = bool(getline(referencelines, referenceline));
+            bool morefast = bool(getline(fastlines, fastline));
+            if (!morereference) referenceline = "<none>";
+            if (!morefast) fastline = "<none>";
+            if (referenceline != fastline || (!morereference && !morefast)){
+                break;
             }
         }
+        cout << "line " << i + 1 << ": " << lines[i] << endl;
+        cout << "  reference: " << referenceline << endl;
+        cout << "  fast: " << fastline << endl;
+    }
+    cout << "commands " << lines.size() << endl;
+    cout << "reference " << (long long)(lines.size() / max(referenceseconds, 1e-9)) << " commands/s" << endl;
+    cout << "fast " << (long long)(lines.size() / max(fastseconds, 1e-9)) << " commands/s" << endl;
+    cout << "not compared " << notcompared << endl;
+    if (changed > 0){
+        cout << "warning: " << changed << " commands change state the reference does not know about, later outputs may differ" << endl;
+    }
+    cout << "mismatches " << mismatches << endl;
+    return mismatches;
+}
 
-        else if (command == "showCalendar"){
-            string cname, venuename, country;
-            if (!readQuotedString(iss, cname) || !readQuotedString(iss, venuename) || !readQuotedString(iss, country)) {
-                cout << -1 << endl << "Error" << endl;
-                continue;
-            }
-            if (!cname.empty() && !venuename.empty() && !country.empty()){
-                events.showCalendar(cname, venuename, country);
-            }
-            else{
-                cout << -1 << endl << "Error" << endl;
-            }
+//function that writes a random command log for replayLog, biased towards the edge cases of the engine: events ending at
+//midnight, overlapping reservations, cascade deletes and malformed input. Recurring events are left out as the reference
+//engine does not know them
+void fuzzLog(unsigned long count, unsigned long seed){
+    mt19937 rng(seed);
+    auto pick = [&](int n){
+        return (int)(rng() % n);
+    };
+    time_t t = time(nullptr);
+    tm today;
+    localtime_r(&t, &today);
+    long firstday = dayNumber(to_string(today.tm_year + 1900) + "-" + to_string(today.tm_mon + 1) + "-" + to_string(today.tm_mday)) + 1;
+    auto date = [&](){
+        return "\"" + dateFromDayNumber(firstday + pick(20)) + "\"";
+    };
+    auto hour = [&](int minutes){
+        static const char *edges[] = {"00:00", "23:30", "23:45", "00:15", "12:10", "24:00"};
+        if (pick(8) == 0){
+            return "\"" + string(edges[pick(6)]) + "\"";
+        }
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "\"%02d:%02d\"", minutes / 60 % 24, minutes % 60);
+        return string(buffer);
+    };
+    //most events are valid so that they pile up, some end at midnight
+    auto hours = [&](){
+        static const int nearmidnight[] = {0, 15, 23 * 60, 23 * 60 + 30};
+        int from = pick(6) == 0 ? nearmidnight[pick(4)] : pick(96) * 15;
+        int to = pick(4) == 0 ? 24 * 60 : min(24 * 60, from + 15 * (1 + pick(12)));
+        return hour(from) + " " + hour(to);
+    };
+    const char *types[] = {"Concert", "Games", "Convention", "Conference", "Party"};
+    const char *malformed[] = {"", "addEvent \"C0\" \"V0\"", "addVenue \"V9\" \"s:ci\" 10", "showVenues \"a:b:c:\"", "reserveVenue", "hello world", "deleteEvent \"C0\" \"V0\" \"X\" \"2020-01-01\" \"10:00\" \"E0\""};
+
+    //every venue and congregation exists from the start, so that most commands reach the engine
+    for (int v = 0; v < 3; v++){
+        cout << "addVenue \"V" << v << "\" \"s:ci:st:1:" << (v == 2 ? "Y" : "X") << "\" " << 1 + pick(600) << endl;
+    }
+    for (int c = 0; c < 4; c++){
+        string from = date(), to = date();
+        if (from > to) swap(from, to);
+        cout << "addCongregation \"C" << c << "\" \"" << types[pick(4)] << "\" " << from << " " << to << endl;
+        cout << "reserveVenue \"V" << c % 3 << "\" \"" << (c % 3 == 2 ? "Y" : "X") << "\" \"C" << c << "\"" << endl;
+    }
+    for (size_t i = 0; i < count; i++){
+        int c = pick(4);
+        string cname = "\"C" + to_string(c) + "\"";
+        int v = pick(4) == 0 ? pick(3) : c % 3;//mostly the venue the congregation reserved at the start
+        string venue = "\"V" + to_string(v) + "\"";
+        string country = v == 2 ? "Y" : "X";
+        string quotedcountry = "\"" + country + "\"";
+        string eventname = "\"E" + to_string(pick(6)) + "\"";
+        int k = pick(100);
+        if (k < 8){
+            string from = date(), to = date();
+            if (from > to) swap(from, to);
+            cout << "addCongregation " << cname << " \"" << types[pick(5)] << "\" " << from << " " << to << endl;
         }
+        else if (k < 11) cout << "deleteCongregation " << cname << endl;
+        else if (k < 15) cout << "addVenue " << venue << " \"s:ci:st:" << pick(2) << ":" << country << "\" " << pick(600) << endl;
+        else if (k < 17) cout << "deleteVenue " << venue << " " << quotedcountry << endl;
+        else if (k < 27) cout << "reserveVenue " << venue << " " << quotedcountry << " " << cname << endl;
+        else if (k < 30) cout << "freeVenue " << venue << " " << quotedcountry << " " << cname << endl;
+        else if (k < 58) cout << "addEvent " << cname << " " << venue << " " << quotedcountry << " " << date() << " " << hours() << " " << eventname << endl;
+        else if (k < 64) cout << "deleteEvent " << cname << " " << venue << " " << quotedcountry << " " << date() << " " << hour(pick(96) * 15) << " " << eventname << endl;
+        else if (k < 71) cout << "showEvents " << venue << " " << quotedcountry << " " << date() << endl;
+        else if (k < 80) cout << "showCalendar " << cname << " " << venue << " " << quotedcountry << endl;
+        else if (k < 83) cout << "showEventsBetween " << date() << " " << date() << endl;
+        else if (k < 86) cout << "bookedHours " << venue << " " << quotedcountry << " " << date() << endl;
+        else if (k < 88) cout << "utilization " << quotedcountry << endl;
+        else if (k < 90) cout << "eventCounts \"" << types[pick(5)] << "\" " << date() << " " << date() << endl;
+        else if (k < 92) cout << "showCongregations" << endl;
+        else if (k < 94) cout << "showReserved " << cname << endl;
+        else if (k < 96) cout << "showVenues \"ci:st::" << country << "\"" << endl;
+        else if (k < 97) cout << "compact" << endl;
+        else cout << malformed[pick(7)] << endl;
+    }
+}
+
+//function to read a whole non-negative number from an argument, false if it is not one
+bool parseCount(const char *arg, unsigned long &value){
+    char *end = nullptr;
+    errno = 0;
+    value = strtoul(arg, &end, 10);
+    return *arg >= '0' && *arg <= '9' && *end == '\0' && errno == 0;
+}
 
-        else if (command == "End"){
+//function to print how the program is called, returns the exit code of a usage error
+int usage(){
+    cerr << "usage: adv_scheduler [--archive <dir>] [--load <file>] [--pipeline]" << endl;
+    cerr << "       adv_scheduler --replay <file>" << endl;
+    cerr << "       adv_scheduler --fuzz <count> <seed>" << endl;
+    return 1;
+}
+
+int main(int argc, char *argv[]){
+    string replaypath, loadpath, archivedir;
+    unsigned long fuzzcount = 0, fuzzseed = 0;
+    bool replay = false, fuzz = false, archive = false, load = false, pipeline = false;
+    //the options are read in one pass and in any order, anything else is a usage error
+    for (int i = 1; i < argc; i++){
+        string option = argv[i];
+        //--replay <file> compares the engine with the reference engine on a recorded command log
+        if (option == "--replay" && i + 1 < argc && !replay){
+            replay = true;
+            replaypath = argv[++i];
+        }
+        //--fuzz <count> <seed> writes a random command log to replay
+        else if (option == "--fuzz" && i + 2 < argc && !fuzz){
+            fuzz = true;
+            if (!parseCount(argv[++i], fuzzcount) || !parseCount(argv[++i], fuzzseed)){
+                return usage();
+            }
+        }
+        //--archive <dir> moves past events and reservations to segments in that directory once a day
+        else if (option == "--archive" && i + 1 < argc && !archive){
+            archive = true;
+            archivedir = argv[++i];
+        }
+        //--load <file> replays a command file before reading the input
+        else if (option == "--load" && i + 1 < argc && !load){
+            load = true;
+            loadpath = argv[++i];
+        }
+        //--pipeline overlaps reading, executing and writing for large command streams
+        else if (option == "--pipeline" && !pipeline){
+            pipeline = true;
+        }
+        else{
+            return usage();
+        }
+    }
+    //replaying and fuzzing do not read the input, so they take no other option
+    if ((replay || fuzz) && replay + fuzz + archive + load + pipeline > 1){
+        return usage();
+    }
+    if (replay){
+        return replayLog(replaypath) == 0 ? 0 : 1;
+    }
+    if (fuzz){
+        fuzzLog(fuzzcount, fuzzseed);
+        return 0;
+    }
+    EventList events;
+    if (archive){
+        if (archivedir.empty()){
+            return usage();
+        }
+        events.archivedir = archivedir;
+    }
+    if (load){
+        LoadResult loaded = loadFile(events, loadpath);
+        if (loaded != LoadResult::Loaded){
+            return loaded == LoadResult::Failed ? 1 : 0;
+        }
+    }
+    if (pipeline){
+        runPipeline(events);
+        return 0;
+    }
+    string input;
+    while (getline(cin, input)){
+        if (!applyCommand(events, parseLine(input))){
             break;
         }
     }